@@ -26,7 +26,10 @@ do
         ${DC} ${item} ${DFLAGS} -c -oq -odobjs
 done
 
-if [ -z "${DYNAMIC_RUNTIME}" ]; then
+if [ -n "${SHARED_RUNTIME}" ]; then
+  echo "SHARED"
+  x86_64-pc-xomb-ld -nostdlib -nodefaultlibs -T${ROOT}/app/build/elf-shared.ld -o ${TARGET} `ls objs/*.o` ${ROOT}/runtimes/mindrt/drt0.a ${ROOT}/runtimes/mindrt/drtmain.a -R ${ROOT}/runtimes/mindrt/mindrt.shared ${EXTRA_LIBS}
+elif [ -z "${DYNAMIC_RUNTIME}" ]; then
   x86_64-pc-xomb-ld -nostdlib -nodefaultlibs -T${ROOT}/app/build/elf.ld -o ${TARGET} `ls objs/*.o` ${ROOT}/runtimes/mindrt/drt0.a ${ROOT}/runtimes/mindrt/mindrt.a ${ROOT}/runtimes/mindrt/libd.a ${EXTRA_LIBS}
 else
   echo "DYNAMIC"
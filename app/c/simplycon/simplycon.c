@@ -0,0 +1,62 @@
+/*
+ * simplycon.c
+ *
+ * Measures console throughput, both for output handed over in one large
+ * write() and for output trickled out a character at a time.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../simplymm/cycle.h"
+
+#define BUFFER_SIZE 64*1024
+#define LINE_LENGTH 64
+#define SINGLE_CHARS 16*1024
+
+void main(int argc, char** argv) {
+
+	ticks bulk_t0, bulk_t1, single_t0, single_t1;
+
+	// clock rate, in MHz, to turn ticks into time
+	double mhz = 1000.0;
+
+	if (argc > 1) {
+		mhz = atof(argv[1]);
+	}
+
+	char* buffer = (char*)malloc(BUFFER_SIZE);
+
+	int i;
+
+	// printable lines, so every line also causes a scroll
+	for (i = 0; i < BUFFER_SIZE; i++) {
+		if ((i % LINE_LENGTH) == LINE_LENGTH - 1) {
+			buffer[i] = '\n';
+		}
+		else {
+			buffer[i] = 'a' + (i % 26);
+		}
+	}
+
+	bulk_t0 = getticks();
+	write(1, buffer, BUFFER_SIZE);
+	bulk_t1 = getticks();
+
+	single_t0 = getticks();
+	for (i = 0; i < SINGLE_CHARS; i++) {
+		write(1, &buffer[i], 1);
+	}
+	single_t1 = getticks();
+
+	double bulk = elapsed(bulk_t1, bulk_t0);
+	double single = elapsed(single_t1, single_t0);
+
+	printf("\nBulk Elapsed : %f\n", bulk);
+	printf("Bulk chars/sec : %f\n", ((double)BUFFER_SIZE * mhz * 1000000.0) / bulk);
+	printf("Single Elapsed : %f\n", single);
+	printf("Single chars/sec : %f\n", ((double)SINGLE_CHARS * mhz * 1000000.0) / single);
+}
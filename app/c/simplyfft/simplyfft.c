@@ -8,10 +8,23 @@
  * Code is from a module by Dmitry Karasik, and available:
  *   http://cpansearch.perl.org/src/KARASIK/IPA-1.07/Global/fft.c
  *
+ * That is the baseline, against which the Stockham FFT of the libos
+ * numeric library is measured, on one worker and on as many as are asked
+ * for.  Both transform the same way, back to front and divided by the
+ * length, as fft_1d does with an isign of 1.
+ *
+ * USAGE: simplyfft [MHz] [threads]
+ *
+ * Rates assume a clock of the given MHz, as there is no other clock to go
+ * by, and count 5 n log2(n) operations for a transform of n points.
+ *
  */
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
+
+#include "cycle.h"
 
 #define SWAP(a,b) tempr=(a); (a)=(b); (b)=tempr
 #define TWOPI (2*3.14159265358979323846264338327950288419716939937510)
@@ -33,6 +46,9 @@
 void perfPoll(int);
 double sin(double);
 
+/* libos numeric library, through the C bindings */
+int numericFFT(double* data, double* work, unsigned long n, int inverse, int threads);
+
 static void fft_1d(double *data, int nn, int isign)
 {
 	int n, mmax, m, j, istep, i;
@@ -122,9 +138,72 @@ double sin(double x) {
 	return temp;
 }
 
-void main() {
+#define ITERATIONS 200
+
+#define DEFAULT_MHZ 2000
+#define DEFAULT_THREADS 4
+
+static unsigned long mhz = DEFAULT_MHZ;
+
+static void report(char* name, double cycles) {
+	double points = INPUTSIZE >> 1;
+	double flops = 0;
+	double seconds = cycles / ((double)mhz * 1000000.0);
+	unsigned long n;
+
+	for (n = INPUTSIZE >> 1; n > 1; n >>= 1) {
+		flops += 5.0 * points;
+	}
+
+	flops *= ITERATIONS;
+
+	printf("%-24s %16.0f cycles %8.3f GFLOP/s\n", name, cycles, flops / seconds / 1000000000.0);
+}
+
+/* the largest difference from the baseline's answer, relative to the
+   largest part of that; its sin() is only good to a few places */
+static double difference(double* a, double* b) {
+	double largest = 0, scale = 0;
+	int i;
+
+	for (i = 0; i < INPUTSIZE; i++) {
+		double d = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+		double m = b[i] > 0 ? b[i] : -b[i];
+
+		if (d > largest) {
+			largest = d;
+		}
+
+		if (m > scale) {
+			scale = m;
+		}
+	}
+
+	return scale > 0 ? largest / scale : largest;
+}
+
+int main(int argc, char** argv) {
 	double* input;
+	double* baseline;
+	double* data;
+	double* work;
+
+	ticks t0, t1;
+	int threads = DEFAULT_THREADS;
+	char name[32];
+
+	if (argc > 1) {
+		mhz = strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		threads = atoi(argv[2]);
+	}
+
 	input = (double*)malloc(sizeof(double) * INPUTSIZE);
+	baseline = (double*)malloc(sizeof(double) * INPUTSIZE);
+	data = (double*)malloc(sizeof(double) * INPUTSIZE);
+	work = (double*)malloc(sizeof(double) * INPUTSIZE);
 
 	srand(0);
 	int i;
@@ -132,10 +211,52 @@ void main() {
 		input[i] = (double)rand();
 	}
 
+	printf("simplyfft: %d points, %d times, at %lu MHz\n", INPUTSIZE >> 1, ITERATIONS, mhz);
+
+	memcpy(baseline, input, sizeof(double) * INPUTSIZE);
+
 	perfPoll(0);
-	for(i = 0; i < 200; i++) {
-		fft_1d(input, INPUTSIZE>>1, 1);
+	t0 = getticks();
+	for(i = 0; i < ITERATIONS; i++) {
+		fft_1d(baseline, INPUTSIZE>>1, 1);
 	}
+	t1 = getticks();
 	perfPoll(0);
-	for(;;) {}
+
+	report("baseline", elapsed(t1, t0));
+
+	// the answer to compare against, after a single transform
+	memcpy(baseline, input, sizeof(double) * INPUTSIZE);
+	fft_1d(baseline, INPUTSIZE>>1, 1);
+
+	memcpy(data, input, sizeof(double) * INPUTSIZE);
+
+	t0 = getticks();
+	for(i = 0; i < ITERATIONS; i++) {
+		numericFFT(data, work, INPUTSIZE>>1, 1, 1);
+	}
+	t1 = getticks();
+
+	report("stockham, 1 thread", elapsed(t1, t0));
+
+	memcpy(data, input, sizeof(double) * INPUTSIZE);
+	numericFFT(data, work, INPUTSIZE>>1, 1, 1);
+	printf("%-24s relative difference %g\n", "", difference(data, baseline));
+
+	memcpy(data, input, sizeof(double) * INPUTSIZE);
+
+	t0 = getticks();
+	for(i = 0; i < ITERATIONS; i++) {
+		numericFFT(data, work, INPUTSIZE>>1, 1, threads);
+	}
+	t1 = getticks();
+
+	sprintf(name, "stockham, %d threads", threads);
+	report(name, elapsed(t1, t0));
+
+	memcpy(data, input, sizeof(double) * INPUTSIZE);
+	numericFFT(data, work, INPUTSIZE>>1, 1, threads);
+	printf("%-24s relative difference %g\n", "", difference(data, baseline));
+
+	return 0;
 }
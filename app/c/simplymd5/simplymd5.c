@@ -1,16 +1,34 @@
 /*
  * simplymd5.c
  *
- * This code will compute the md5 hash of some range of memory.
+ * This code will compute the md5 hash of some range of memory, and
+ * measure how fast that goes: the plain C below, one message at a time,
+ * against the libos hashing code, which takes four at once in the lanes of
+ * the vector registers.  SHA-1, SHA-256 and CRC-32C are measured the same
+ * way, with and without the SHA extensions and the crc32 instruction.
+ *
+ * USAGE: simplymd5 [MHz] [file]
+ *
+ * Rates assume a clock of the given MHz, as there is no other clock to go
+ * by.  Given a file, it hashes that instead, as mapped by mmap, which
+ * hands out the file's own memory rather than copying it.
  *
  */
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 #define WORKLOAD_SIZE (1000000)
-#define ITERATIONS 10000
+#define ITERATIONS 16
+
+/* messages hashed side by side */
+#define LANES 4
+
+#define DEFAULT_MHZ 2000
 
 void perfPoll(int i)
 /*
@@ -19,6 +37,26 @@ void perfPoll(int i)
 }*/
 ;
 
+/* libos hashing, through the C bindings */
+void hashMD5(unsigned char* data, unsigned long length, unsigned char* digest);
+void hashSHA1(unsigned char* data, unsigned long length, unsigned char* digest);
+void hashSHA256(unsigned char* data, unsigned long length, unsigned char* digest);
+void hashMD5Multi(unsigned char** data, unsigned long* lengths, int count, unsigned char* digests);
+void hashSHA1Multi(unsigned char** data, unsigned long* lengths, int count, unsigned char* digests);
+void hashSHA256Multi(unsigned char** data, unsigned long* lengths, int count, unsigned char* digests);
+unsigned int hashCRC32C(unsigned char* data, unsigned long length, unsigned int crc);
+int hashHasSHA();
+int hashHasCRC32C();
+void hashIgnoreExtensions(int ignore);
+
+/* mmap, through the C bindings, which have no sys/mman.h to go with it */
+void* mmap(void* addr, unsigned long length, int prot, int flags, int fd, long offset);
+int munmap(void* addr, unsigned long length);
+
+#define PROT_READ 1
+#define MAP_SHARED 1
+#define MAP_FAILED ((void*)-1)
+
 #define SIZEOF_LONG 8
 
 typedef unsigned int uint32;
@@ -322,26 +360,237 @@ void MD5Transform(uint32 buf[4], uint32 const in[16])
 
 
 
-void main() {
-	char* bigMessage = (char*)malloc(sizeof(char) * WORKLOAD_SIZE);
-	char message[]="String you wish to hash";
-	char hash[33];
+static unsigned long long rdtsc(void) {
+	unsigned int lo, hi;
+
+	__asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+
+	return ((unsigned long long)hi << 32) | lo;
+}
+
+static unsigned long mhz = DEFAULT_MHZ;
+
+static void report(char* name, unsigned long long cycles) {
+	double bytes = (double)WORKLOAD_SIZE * LANES * ITERATIONS;
+	double seconds = (double)cycles / ((double)mhz * 1000000.0);
+
+	printf("%-24s %12llu cycles %8.3f GB/s %6.2f cycles/byte\n",
+		name, cycles, bytes / seconds / 1000000000.0, (double)cycles / bytes);
+}
+
+static void check(char* name, unsigned char* a, unsigned char* b, int size) {
+	if (memcmp(a, b, size) != 0) {
+		printf("%s: digests differ!\n", name);
+	}
+}
+
+static int hashFile(char* path) {
+	struct stat st;
+	unsigned char digest[16];
+	unsigned char* data;
+	unsigned long long cycles;
+	int fd, i;
+
+	fd = open(path, O_RDONLY);
+
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		printf("simplymd5: cannot open %s\n", path);
+		return 1;
+	}
+
+	if (st.st_size == 0) {
+		printf("simplymd5: %s is empty\n", path);
+		close(fd);
+		return 1;
+	}
+
+	data = (unsigned char*)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	if (data == MAP_FAILED) {
+		printf("simplymd5: cannot map %s\n", path);
+		close(fd);
+		return 1;
+	}
+
+	cycles = rdtsc();
+	hashMD5(data, st.st_size, digest);
+	cycles = rdtsc() - cycles;
 
-	int i;
+	for (i = 0; i < 16; i++) {
+		printf("%02x", digest[i]);
+	}
+
+	printf("  %s\n", path);
+
+	printf("%lu bytes, %llu cycles %8.3f GB/s\n", (unsigned long)st.st_size, cycles,
+		(double)st.st_size / ((double)cycles / ((double)mhz * 1000000.0)) / 1000000000.0);
+
+	munmap(data, st.st_size);
+	close(fd);
+
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	unsigned char* buffers[LANES];
+	unsigned long lengths[LANES];
+
+	unsigned char scalar[LANES][32];
+	unsigned char vector[LANES][32];
+	unsigned char sha1[LANES][20];
+
+	unsigned long long start;
+	unsigned int crc = 0;
+	int i, l;
+
+	if (argc > 1) {
+		mhz = strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		return hashFile(argv[2]);
+	}
+
+	for (l = 0; l < LANES; l++) {
+		buffers[l] = (unsigned char*)malloc(WORKLOAD_SIZE);
+		lengths[l] = WORKLOAD_SIZE;
+
+		for (i = 0; i < WORKLOAD_SIZE; i++) {
+			buffers[l][i] = (unsigned char)(i * 7 + l);
+		}
+	}
+
+	printf("simplymd5: %d x %d bytes, %d times, at %lu MHz\n", LANES, WORKLOAD_SIZE, ITERATIONS, mhz);
+
+	/* MD5: the C above, and the lanes */
 	perfPoll(0);
+	start = rdtsc();
 	for (i = 0; i < ITERATIONS; i++) {
-		char* buf = bigMessage;
-		long len = WORKLOAD_SIZE;
-
-		int endian = 1;
-		unsigned char bindigest[16];
-		MD5_CTX ctx;
+		for (l = 0; l < LANES; l++) {
+			int endian = 1;
+			MD5_CTX ctx;
 
-		MD5Init(&ctx, * ( (char*) &endian));
-		MD5Update(&ctx, buf, (unsigned int) len);
-		MD5Final(bindigest, &ctx);
+			MD5Init(&ctx, * ( (char*) &endian));
+			MD5Update(&ctx, buffers[l], (unsigned int) lengths[l]);
+			MD5Final(scalar[l], &ctx);
+		}
 	}
+	report("md5 scalar", rdtsc() - start);
 	perfPoll(0);
-	for(;;){}
-}
 
+	start = rdtsc();
+	for (i = 0; i < ITERATIONS; i++) {
+		hashMD5Multi(buffers, lengths, LANES, &vector[0][0]);
+	}
+	report("md5 4 lanes", rdtsc() - start);
+
+	for (l = 0; l < LANES; l++) {
+		check("md5", scalar[l], &vector[0][0] + l * 16, 16);
+	}
+
+	/* SHA-1 and SHA-256: plain, the lanes, and the SHA extensions */
+	hashIgnoreExtensions(1);
+
+	start = rdtsc();
+	for (i = 0; i < ITERATIONS; i++) {
+		for (l = 0; l < LANES; l++) {
+			hashSHA1(buffers[l], lengths[l], sha1[l]);
+		}
+	}
+	report("sha1 scalar", rdtsc() - start);
+
+	start = rdtsc();
+	for (i = 0; i < ITERATIONS; i++) {
+		hashSHA1Multi(buffers, lengths, LANES, &vector[0][0]);
+	}
+	report("sha1 4 lanes", rdtsc() - start);
+
+	for (l = 0; l < LANES; l++) {
+		check("sha1", sha1[l], &vector[0][0] + l * 20, 20);
+	}
+
+	start = rdtsc();
+	for (i = 0; i < ITERATIONS; i++) {
+		for (l = 0; l < LANES; l++) {
+			hashSHA256(buffers[l], lengths[l], scalar[l]);
+		}
+	}
+	report("sha256 scalar", rdtsc() - start);
+
+	start = rdtsc();
+	for (i = 0; i < ITERATIONS; i++) {
+		hashSHA256Multi(buffers, lengths, LANES, &vector[0][0]);
+	}
+	report("sha256 4 lanes", rdtsc() - start);
+
+	for (l = 0; l < LANES; l++) {
+		check("sha256", scalar[l], &vector[0][0] + l * 32, 32);
+	}
+
+	hashIgnoreExtensions(0);
+
+	if (hashHasSHA()) {
+		start = rdtsc();
+		for (i = 0; i < ITERATIONS; i++) {
+			for (l = 0; l < LANES; l++) {
+				hashSHA1(buffers[l], lengths[l], vector[l]);
+			}
+		}
+		report("sha1 extensions", rdtsc() - start);
+
+		for (l = 0; l < LANES; l++) {
+			check("sha1 extensions", sha1[l], vector[l], 20);
+		}
+
+		start = rdtsc();
+		for (i = 0; i < ITERATIONS; i++) {
+			for (l = 0; l < LANES; l++) {
+				hashSHA256(buffers[l], lengths[l], vector[l]);
+			}
+		}
+		report("sha256 extensions", rdtsc() - start);
+
+		for (l = 0; l < LANES; l++) {
+			check("sha256 extensions", scalar[l], vector[l], 32);
+		}
+	}
+	else {
+		printf("no SHA extensions\n");
+	}
+
+	/* CRC-32C: a table, and the crc32 instruction */
+	hashIgnoreExtensions(1);
+
+	start = rdtsc();
+	for (i = 0; i < ITERATIONS; i++) {
+		for (l = 0; l < LANES; l++) {
+			crc = hashCRC32C(buffers[l], lengths[l], crc);
+		}
+	}
+	report("crc32c table", rdtsc() - start);
+
+	hashIgnoreExtensions(0);
+
+	if (hashHasCRC32C()) {
+		unsigned int table = crc;
+
+		crc = 0;
+
+		start = rdtsc();
+		for (i = 0; i < ITERATIONS; i++) {
+			for (l = 0; l < LANES; l++) {
+				crc = hashCRC32C(buffers[l], lengths[l], crc);
+			}
+		}
+		report("crc32c instruction", rdtsc() - start);
+
+		if (crc != table) {
+			printf("crc32c: values differ!\n");
+		}
+	}
+	else {
+		printf("no crc32 instruction\n");
+	}
+
+	return 0;
+}
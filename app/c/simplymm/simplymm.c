@@ -3,32 +3,95 @@
  *
  *
  * Code computes matrix multiplication of a matrix of ints of some
- * arbitrary size denoted by MATRIX_DIM.
+ * arbitrary size denoted by MATRIX_DIM, the plain way, and then of
+ * doubles with the blocked multiply of the libos numeric library, on one
+ * worker and on as many as are asked for.
+ *
+ * USAGE: simplymm [MHz] [threads]
+ *
+ * Rates assume a clock of the given MHz, as there is no other clock to go
+ * by.
  *
  */
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
 
 #include "cycle.h"
 
 #define MATRIX_DIM 2048
 
+#define DEFAULT_MHZ 2000
+#define DEFAULT_THREADS 4
+
+// Where the matrices' pages come from: a NUMA node, -1 for the node of the
+// cpu that touches them, or -2 for each node in turn
+#ifndef PLACEMENT
+#define PLACEMENT -1
+#endif
+
+int bindHeap(int);
+
+/* libos numeric library, through the C bindings */
+void numericGEMM(unsigned long m, unsigned long n, unsigned long k, double* a, unsigned long lda,
+	double* b, unsigned long ldb, double* c, unsigned long ldc, int threads);
+
 struct bigint {
 	int a;
 	int b;
 };
 
-void main() {
+static unsigned long mhz = DEFAULT_MHZ;
+
+static void report(char* name, double cycles) {
+	double flops = 2.0 * MATRIX_DIM * MATRIX_DIM * MATRIX_DIM;
+	double seconds = cycles / ((double)mhz * 1000000.0);
+
+	printf("%-24s %16.0f cycles %8.3f GFLOP/s\n", name, cycles, flops / seconds / 1000000000.0);
+}
+
+/* the blocked multiply on doubles, against the plain one on ints */
+static void check(char* name, double* C, int** Y) {
+	int i, j;
+
+	for (i = 0; i < MATRIX_DIM; i++) {
+		for (j = 0; j < MATRIX_DIM; j++) {
+			if (C[i * MATRIX_DIM + j] != (double)Y[i][j]) {
+				printf("%s: products differ at %d, %d!\n", name, i, j);
+				return;
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
 
 	ticks header_t0, header_t1, read_t0, read_t1, compute_t0, compute_t1, write_t0, write_t1;
 
+	int threads = DEFAULT_THREADS;
+	char name[32];
+
+	if (argc > 1) {
+		mhz = strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		threads = atoi(argv[2]);
+	}
+
+	bindHeap(PLACEMENT);
+
 	header_t0 = getticks();
 
 	int** Y;
 	int** A;
 	int** B;
 
+	double* CD;
+	double* AD;
+	double* BD;
+
 	int i,j,k;
 
 	Y = (int**)malloc(sizeof(int*)*MATRIX_DIM);
@@ -41,8 +104,26 @@ void main() {
 		B[i] = (int*)malloc(sizeof(int)*MATRIX_DIM);
 	}
 
+	CD = (double*)malloc(sizeof(double)*MATRIX_DIM*MATRIX_DIM);
+	AD = (double*)malloc(sizeof(double)*MATRIX_DIM*MATRIX_DIM);
+	BD = (double*)malloc(sizeof(double)*MATRIX_DIM*MATRIX_DIM);
+
+	// small enough that every sum is exact as a double
+	for (i=0; i < MATRIX_DIM; i++) {
+		for (j=0; j < MATRIX_DIM; j++) {
+			Y[i][j] = 0;
+			A[i][j] = (i + j) % 7 - 3;
+			B[i][j] = (i * j) % 5 - 2;
+
+			AD[i * MATRIX_DIM + j] = A[i][j];
+			BD[i * MATRIX_DIM + j] = B[i][j];
+		}
+	}
+
 	header_t1 = getticks();
 
+	printf("simplymm: %d x %d, at %lu MHz\n", MATRIX_DIM, MATRIX_DIM, mhz);
+
 	compute_t0 = getticks();
 	struct bigint bi;
 	for (i=0; i < MATRIX_DIM; i++) {
@@ -61,4 +142,25 @@ void main() {
 	printf("Read Elapsed : %f\n", elapsed(read_t1, read_t0));
 	printf("Compute Elapsed : %f\n", elapsed(compute_t1, compute_t0));
 	printf("Write Elapsed : %f\n", elapsed(write_t1, write_t0));
+
+	report("naive", elapsed(compute_t1, compute_t0));
+
+	compute_t0 = getticks();
+	numericGEMM(MATRIX_DIM, MATRIX_DIM, MATRIX_DIM, AD, MATRIX_DIM, BD, MATRIX_DIM, CD, MATRIX_DIM, 1);
+	compute_t1 = getticks();
+
+	report("blocked, 1 thread", elapsed(compute_t1, compute_t0));
+	check("blocked, 1 thread", CD, Y);
+
+	memset(CD, 0, sizeof(double)*MATRIX_DIM*MATRIX_DIM);
+
+	compute_t0 = getticks();
+	numericGEMM(MATRIX_DIM, MATRIX_DIM, MATRIX_DIM, AD, MATRIX_DIM, BD, MATRIX_DIM, CD, MATRIX_DIM, threads);
+	compute_t1 = getticks();
+
+	sprintf(name, "blocked, %d threads", threads);
+	report(name, elapsed(compute_t1, compute_t0));
+	check(name, CD, Y);
+
+	return 0;
 }
@@ -3,6 +3,8 @@
  *
  * This code just writes random stuff to an array.
  *
+ * USAGE: simplyrnd [iterations]
+ *
  */
 
 #include <stdlib.h>
@@ -11,20 +13,36 @@
 #define SIZE 1024*1024
 #define ITERATIONS 5000
 
+// Where the array's pages come from: a NUMA node, -1 for the node of the
+// cpu that touches them, or -2 for each node in turn
+#ifndef PLACEMENT
+#define PLACEMENT -1
+#endif
+
 void perfPoll(int);
+int bindHeap(int);
+
+int main(int argc, char** argv) {
+	int iterations = ITERATIONS;
+
+	if (argc > 1) {
+		iterations = atoi(argv[1]);
+	}
 
-void main() {
 	srand(0); // OK... not very random, but oh well
 
+	bindHeap(PLACEMENT);
+
 	int* array = (int*)malloc(sizeof(int) * SIZE);
 
 	int i,o;
 	perfPoll(0);
-	for(o = 0; o < ITERATIONS; o++) {
+	for(o = 0; o < iterations; o++) {
 		for(i = 0; i < SIZE; i++) {
 			array[i] = (int)rand();
 		}
 	}
 	perfPoll(0);
-	for(;;){}
+
+	return 0;
 }
@@ -0,0 +1,174 @@
+/*
+ * simplysort.c
+ *
+ *
+ * Code sums, prefix sums and sorts an array of pseudo-random longs with
+ * the parallel algorithms of the libos, on one worker, then two, and so on
+ * up to as many as are asked for, and reports how each scales against one.
+ * Every run starts from the same numbers, and its answers are checked.
+ *
+ * USAGE: simplysort [MHz] [threads] [elements]
+ *
+ * Rates assume a clock of the given MHz, as there is no other clock to go
+ * by.  The default 100 million elements take 800MB, so give the machine
+ * the memory (run.sh --numa gives it 2GB).
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "cycle.h"
+
+#define DEFAULT_ELEMENTS 100000000UL
+
+#define DEFAULT_MHZ 2000
+#define DEFAULT_THREADS 4
+
+// 0 lets the library pick
+#define GRAIN 0
+
+/* libos parallel algorithms, through the C bindings */
+long parallelSumLong(long* data, unsigned long length, unsigned long grain, int threads);
+void parallelPrefixSumLong(long* data, unsigned long length, unsigned long grain, int threads);
+void parallelSortLong(long* data, unsigned long length, unsigned long grain, int threads);
+
+static unsigned long mhz = DEFAULT_MHZ;
+
+// cycles for each on one worker, to scale against
+static double base_sum, base_scan, base_sort;
+
+/* a xorshift generator, so each run sees the same numbers */
+static void fill(long* data, unsigned long n) {
+	unsigned long x = 88172645463325252UL;
+	unsigned long i;
+
+	for (i = 0; i < n; i++) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+
+		// small enough that no sum overflows
+		data[i] = (long)(x >> 32) - 0x80000000L;
+	}
+}
+
+static void report(char* name, int threads, double cycles, double base, unsigned long n) {
+	double seconds = cycles / ((double)mhz * 1000000.0);
+
+	printf("%-12s %2d threads %16.0f cycles %10.1f M/s %6.2fx\n", name, threads, cycles,
+		(double)n / seconds / 1000000.0, base / cycles);
+}
+
+static int run(long* data, unsigned long n, int threads, long expected) {
+	ticks t0, t1;
+	unsigned long i;
+	long sum;
+	double cycles;
+
+	fill(data, n);
+
+	t0 = getticks();
+	sum = parallelSumLong(data, n, GRAIN, threads);
+	t1 = getticks();
+
+	cycles = elapsed(t1, t0);
+	if (threads == 1) {
+		base_sum = cycles;
+	}
+
+	report("sum", threads, cycles, base_sum, n);
+
+	if (sum != expected) {
+		printf("sum: %ld, not %ld!\n", sum, expected);
+		return 1;
+	}
+
+	t0 = getticks();
+	parallelPrefixSumLong(data, n, GRAIN, threads);
+	t1 = getticks();
+
+	cycles = elapsed(t1, t0);
+	if (threads == 1) {
+		base_scan = cycles;
+	}
+
+	report("prefix sum", threads, cycles, base_scan, n);
+
+	if (data[n - 1] != expected) {
+		printf("prefix sum: ends at %ld, not %ld!\n", data[n - 1], expected);
+		return 1;
+	}
+
+	fill(data, n);
+
+	t0 = getticks();
+	parallelSortLong(data, n, GRAIN, threads);
+	t1 = getticks();
+
+	cycles = elapsed(t1, t0);
+	if (threads == 1) {
+		base_sort = cycles;
+	}
+
+	report("sort", threads, cycles, base_sort, n);
+
+	for (i = 1; i < n; i++) {
+		if (data[i] < data[i - 1]) {
+			printf("sort: out of order at %lu!\n", i);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	int threads = DEFAULT_THREADS;
+	unsigned long n = DEFAULT_ELEMENTS;
+	unsigned long i;
+	long expected = 0;
+	long* data;
+	int t;
+
+	if (argc > 1) {
+		mhz = strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2) {
+		threads = atoi(argv[2]);
+	}
+
+	if (argc > 3) {
+		n = strtoul(argv[3], NULL, 10);
+	}
+
+	if (n == 0 || threads < 1) {
+		printf("USAGE: simplysort [MHz] [threads] [elements]\n");
+		return 1;
+	}
+
+	data = (long*)malloc(sizeof(long) * n);
+
+	if (data == NULL) {
+		printf("simplysort: no memory for %lu elements\n", n);
+		return 1;
+	}
+
+	fill(data, n);
+
+	for (i = 0; i < n; i++) {
+		expected += data[i];
+	}
+
+	printf("simplysort: %lu elements, at %lu MHz\n", n, mhz);
+
+	for (t = 1; t <= threads; t++) {
+		if (run(data, n, t, expected)) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -1,6 +1,7 @@
 #!/bin/sh
 
 mkdir -p build/root/binaries
+mkdir -p build/root/lib
 mkdir -p build/iso/binaries
 
 cd runtimes/mindrt
@@ -29,11 +30,36 @@ cd app/c/simplymm
 make || exit
 cd ../../..
 
+cd app/c/simplycon
+make || exit
+cd ../../..
+
+cd app/c/simplymd5
+make || exit
+cd ../../..
+
+cd app/c/simplyfft
+make || exit
+cd ../../..
+
+cd app/c/simplysort
+make || exit
+cd ../../..
+
+cd app/c/simplyrnd
+make || exit
+cd ../../..
+
 cd app/d/hello
 rm -r objs
 ./build || exit
 cd ../../..
 
+cd app/d/tracedump
+rm -r objs
+./build || exit
+cd ../../..
+
 cd app/d/nettest
 rm -r objs
 ./build || exit
@@ -44,6 +70,46 @@ rm -r objs
 ./build || exit
 cd ../../..
 
+cd app/d/gcbench
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/stackbench
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/faultbench
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/sharetest
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/appendbench
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/utfbench
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/floatbench
+rm -r objs
+./build || exit
+cd ../../..
+
+cd app/d/pktgen
+rm -r objs
+./build || exit
+cd ../../..
+
 cd app/d/posix
 rm -r objs
 ./build || exit
@@ -54,6 +120,11 @@ rm -r objs
 ./build || exit
 cd ../../..
 
+cd app/d/benchrun
+rm -r objs
+./build || exit
+cd ../../..
+
 cd app/d/init
 rm -r objs
 ./build || exit
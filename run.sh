@@ -1,18 +1,98 @@
 CURSES="-display curses"
 SATA=""
+DISK=""
 NIC=""
+NUMA=""
 CD="-cdrom build/xomb.iso --boot cd"
+BENCH=""
+SAVE_BASELINE=""
+
+# for --bench: how long the benchmarks may take, in seconds, and where their
+# results are kept
+BENCH_TIMEOUT=${BENCH_TIMEOUT:-1800}
+BENCH_LOG=build/bench.log
+BENCH_BASELINE=tools/bench/baseline
+
+# for --disk: the disk that MinFS is kept on; only what has been written
+# takes up space
+DISK_IMAGE=build/disk.raw
+DISK_SIZE=512G
 
 for arg in $@; do
 	case $arg in
 		-X) CURSES="";;
 		--sata) SATA="-drive id=disk,file=/home/wolfwood/repos/xomb/disk0.raw,if=none -device ahci,id=ahci -device ide-drive,drive=disk,bus=ahci.0";;
+		--disk) DISK="-drive id=disk,file=$DISK_IMAGE,format=raw,if=none -device ahci,id=ahci -device ide-hd,drive=disk,bus=ahci.0";;
 		--nic) NIC="-net none -device e1000,vlan=0,mac=ab:cd:ef:01:02:03";;
+		--numa) NUMA="-smp 4 -m 2048 -numa node,nodeid=0,cpus=0-1,mem=1024 -numa node,nodeid=1,cpus=2-3,mem=1024";;
+		--bench) BENCH=1;;
+		--save-baseline) SAVE_BASELINE=1;;
 	esac
 done
 
-qemu-system-x86_64 -enable-kvm $CURSES $SATA $CD $NIC
+if [ -n "$DISK" ] && [ ! -e $DISK_IMAGE ]; then
+	truncate -s $DISK_SIZE $DISK_IMAGE || exit 1
+fi
+
+if [ -z "$BENCH" ]; then
+	qemu-system-x86_64 -enable-kvm $CURSES $SATA $DISK $CD $NIC $NUMA
+
+	exit
+fi
+
+# --bench: boot the benchmarks entry with no screen, gather what benchrun
+# sends out of the serial port, and compare it against the baseline (or,
+# with --save-baseline, make it the baseline)
+
+KVM=""
+if [ -w /dev/kvm ]; then
+	KVM="-enable-kvm"
+else
+	echo "run.sh: no KVM; cycles will not be comparable to a run with it"
+fi
+
+if [ -z "$NUMA" ]; then
+	NUMA="-smp 4 -m 2048"
+fi
+
+# the same image, but booting the benchmarks without waiting
+rm -rf build/bench-iso
+cp -r build/iso build/bench-iso
+cp LICENSE build/bench-iso/
+sed -i 's/^default\t\t0/default\t\t1/' build/bench-iso/boot/grub/menu.lst
+sed -i 's/^set timeout=2/set default=1\nset timeout=0/' build/bench-iso/boot/grub/grub.cfg
+mkisofs -R -b boot/grub/stage2_eltorito -no-emul-boot -boot-load-size 16 -boot-info-table -input-charset UTF-8 -o build/bench.iso build/bench-iso > /dev/null 2>&1 || exit 1
+
+rm -f $BENCH_LOG
+
+qemu-system-x86_64 $KVM -display none -serial file:$BENCH_LOG $NUMA $SATA $DISK $NIC -cdrom build/bench.iso --boot cd &
+QEMU=$!
+
+WAITED=0
+while ! grep -q '^END ' $BENCH_LOG 2> /dev/null; do
+	if ! kill -0 $QEMU 2> /dev/null; then
+		echo "run.sh: qemu stopped before the benchmarks finished"
+		exit 1
+	fi
+
+	if [ $WAITED -ge $BENCH_TIMEOUT ]; then
+		echo "run.sh: the benchmarks took more than $BENCH_TIMEOUT seconds"
+		kill $QEMU
+		exit 1
+	fi
+
+	sleep 1
+	WAITED=$((WAITED + 1))
+done
+
+kill $QEMU
+
+if [ -n "$SAVE_BASELINE" ]; then
+	grep '^BENCH ' $BENCH_LOG > $BENCH_BASELINE
+	echo "run.sh: saved the baseline to $BENCH_BASELINE"
+fi
 
-exit
+sh tools/bench/compare.sh $BENCH_LOG $BENCH_BASELINE
+exit $?
 
 #qemu-system-x86_64 -enable-kvm -device ahci,id=ahci0,bus=pci.0,multifunction=on,addr=0x4.0x0 -drive file=/home/wolfwood/repos/xomb/disk0.raw,if=none,id=drive-sata-disk0,format=raw -device ide-drive,bus=ahci0.0,drive=drive-sata-disk0,id=sata-disk0 -display curses -cdrom build/xomb.iso --boot cd
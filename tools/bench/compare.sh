@@ -0,0 +1,84 @@
+#!/bin/sh
+
+# USAGE: compare.sh results [baseline]
+#
+# Compares the cycles of each benchmark in results, as benchrun sends them
+# out of the serial port, against those in baseline (tools/bench/baseline,
+# as run.sh --bench --save-baseline leaves it).  Fails if any benchmark
+# failed, or took more than THRESHOLD percent (10, unless set) more cycles
+# than in the baseline.
+
+RESULTS=$1
+BASELINE=${2:-tools/bench/baseline}
+THRESHOLD=${THRESHOLD:-10}
+
+if [ -z "$RESULTS" ] || [ ! -f "$RESULTS" ]; then
+	echo "USAGE: compare.sh results [baseline]"
+	exit 1
+fi
+
+if ! grep -q '^END ' "$RESULTS"; then
+	echo "compare: $RESULTS stops short; the run did not finish"
+	exit 1
+fi
+
+if [ ! -f "$BASELINE" ]; then
+	echo "compare: no baseline at $BASELINE; cycles are shown alone"
+	BASELINE=/dev/null
+fi
+
+awk -v baseline="$BASELINE" -v threshold="$THRESHOLD" '
+	# the value of name=value among the fields of a BENCH line
+	function field(name,    i) {
+		for (i = 3; i <= NF; i++) {
+			if (index($i, name "=") == 1) {
+				return substr($i, length(name) + 2)
+			}
+		}
+
+		return ""
+	}
+
+	FILENAME == baseline {
+		if ($1 == "BENCH") {
+			base[$2] = field("cycles")
+		}
+
+		next
+	}
+
+	$1 == "BENCH" {
+		cycles = field("cycles")
+		status = field("exit")
+
+		if (status != "0") {
+			printf "%-16s FAILED (exit %s) %s\n", $2, status, field("error")
+			bad = 1
+			next
+		}
+
+		if (base[$2] == "" || base[$2] == 0) {
+			printf "%-16s %16s cycles\n", $2, cycles
+			next
+		}
+
+		change = (cycles - base[$2]) * 100 / base[$2]
+
+		if (change > threshold) {
+			verdict = "SLOWER"
+			bad = 1
+		}
+		else if (change < -threshold) {
+			verdict = "faster"
+		}
+		else {
+			verdict = "ok"
+		}
+
+		printf "%-16s %16s cycles %+8.1f%% %s\n", $2, cycles, change, verdict
+	}
+
+	END {
+		exit bad
+	}
+' "$BASELINE" "$RESULTS"